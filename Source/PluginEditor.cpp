@@ -26,7 +26,6 @@ Sjf_convoAudioProcessorEditor::Sjf_convoAudioProcessorEditor (Sjf_convoAudioProc
     loadImpulseButton.onClick = [this]
     {
         audioProcessor.loadImpulse();
-        waveformThumbnail.drawWaveform( audioProcessor.getIRBuffer() );
     };
     loadImpulseButton.setTooltip( "Use this to load a new .wav/.aiff file to use as an impulse response" );
     
@@ -49,7 +48,6 @@ Sjf_convoAudioProcessorEditor::Sjf_convoAudioProcessorEditor (Sjf_convoAudioProc
         max = min + dif;
         startAndEndSlider.setMinAndMaxValues( min, max );
         startAndEndSlider.onMouseEvent();
-        waveformThumbnail.drawWaveform( audioProcessor.getIRBuffer() );
     };
     reverseImpulseButton.setTooltip( "This will reverse the impulse response and any start/end or envelope settings" );
     
@@ -125,13 +123,13 @@ Sjf_convoAudioProcessorEditor::Sjf_convoAudioProcessorEditor (Sjf_convoAudioProc
     {
 //        if (m_justRestoreGUIFlag){ return; }
         audioProcessor.setAmplitudeEnvelope( waveformThumbnail.getEnvelope() );
-        waveformThumbnail.drawWaveform( audioProcessor.getIRBuffer() );
     };
-    waveformThumbnail.drawWaveform( audioProcessor.getIRBuffer() );
     auto env = audioProcessor.getAmplitudeEnvelope();
     waveformThumbnail.setEnvelope( env );
     waveformThumbnail.setTooltip( "This displays the impulse response currently in use. \nIt also allows you to create an amplitude envelope which is applied to the impulse. \nTo create new breakpoints in the envelope hold shift and click, to delete a breakpoint hold alt and click the breakpoint." );
     
+    addAndMakeVisible( &waveformOverview );
+    
     addAndMakeVisible( &fileNameLabel );
     fileNameLabel.setColour( juce::Label::backgroundColourId, juce::Colours::white.withAlpha(0.0f) );
     fileNameLabel.setColour( juce::Label::textColourId, juce::Colours::white.withAlpha(0.3f) );
@@ -238,6 +236,7 @@ void Sjf_convoAudioProcessorEditor::resized()
     waveformThumbnail.setBounds(loadImpulseButton.getRight() + INDENT, TEXT_HEIGHT, SLIDER_SIZE*4, SLIDER_SIZE*2 + INDENT*3 + TEXT_HEIGHT );
     fileNameLabel.setBounds(waveformThumbnail.getX(), waveformThumbnail.getBottom()-TEXT_HEIGHT, waveformThumbnail.getWidth(), TEXT_HEIGHT );
     startAndEndSlider.setBounds( waveformThumbnail.getX(), waveformThumbnail.getBottom(), waveformThumbnail.getWidth(), TEXT_HEIGHT );
+    waveformOverview.setBounds( waveformThumbnail.getBounds() );
 
     
     lpfCutoffSlider.setBounds( waveformThumbnail.getRight() + INDENT, waveformThumbnail.getY() + TEXT_HEIGHT, SLIDER_SIZE, SLIDER_SIZE );
@@ -260,6 +259,8 @@ void Sjf_convoAudioProcessorEditor::timerCallback()
         audioProcessor.setStateReloaded( false );
         setNonAutomatableValues();
     }
+    // overviews are built in the background, so they arrive some time after the action that triggered them
+    if ( audioProcessor.getWaveformOverview() != waveformOverview.getOverview() ){ waveformOverview.setOverview( audioProcessor.getWaveformOverview() ); }
     fileNameLabel.setText( audioProcessor.getFileName(), juce::dontSendNotification );
     sjf_setTooltipLabel( this, MAIN_TOOLTIP, tooltipLabel );
 }
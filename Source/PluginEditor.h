@@ -47,6 +47,8 @@ private:
 
     
     sjf_waveform waveformThumbnail;
+    // drawn on top of waveformThumbnail, with the same bounds
+    sjf_waveformOverviewDisplay waveformOverview;
     
     
     std::unique_ptr< juce::AudioProcessorValueTreeState::ButtonAttachment > filterOnOffButtonAttachment;
@@ -26,7 +26,7 @@ Sjf_convoAudioProcessor::Sjf_convoAudioProcessor()
 
 
     m_convBuffer.setSize( 2, getBlockSize() );
-    m_convo.trimImpulseEnd( true );
+    trimImpulseEnd( true );
     
 //    setNonAutomatableParameterValues();
     wetMixParameter = parameters.getRawParameterValue("mix");
@@ -85,7 +85,7 @@ bool Sjf_convoAudioProcessor::isMidiEffect() const
 
 double Sjf_convoAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    return m_engineMeasurement.getImpulseLengthSeconds() + ( preDelayParameter != nullptr ? 0.001 * preDelayParameter->load() : 0.0 );
 }
 
 int Sjf_convoAudioProcessor::getNumPrograms()
@@ -117,6 +117,12 @@ void Sjf_convoAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBl
 {
     m_convo.prepare( sampleRate, samplesPerBlock );
     m_convBuffer.setSize( 2, samplesPerBlock );
+    // the engine doesn't report its latency, so it is measured from a private instance... reported even when it is 0, so the host never keeps a stale value
+    auto latency = m_engineMeasurement.prepare( sampleRate, samplesPerBlock );
+    setLatencySamples( latency );
+    m_dryDelay.setSize( 2, latency );
+    m_dryDelay.clear();
+    m_dryDelayPosition = 0;
 }
 
 void Sjf_convoAudioProcessor::releaseResources()
@@ -152,6 +158,17 @@ bool Sjf_convoAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts
 #endif
 
 void Sjf_convoAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processSamples( buffer );
+}
+
+void Sjf_convoAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processSamples( buffer );
+}
+
+template < typename T >
+void Sjf_convoAudioProcessor::processSamples( juce::AudioBuffer< T >& buffer )
 {
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
@@ -166,7 +183,9 @@ void Sjf_convoAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, ju
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, bufferSize );
 
+    // the convolution engine runs in single precision, so this copy doubles as the conversion for double precision hosts... the dry signal stays in the host's precision
     m_convBuffer.makeCopyOf( buffer );
+    delayDrySignal( buffer );
     
     
     auto inLevel = std::pow( 10, m_inputLevelDB/20 );
@@ -188,10 +207,40 @@ void Sjf_convoAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, ju
 //    DBG( "dry " << dry << " wet " << wet );
     for ( int c = 0; c < totalNumOutputChannels; c++ )
     {
-        buffer.addFrom( c, 0, m_convBuffer, c, 0, bufferSize );
+        if constexpr ( std::is_same< T, float >::value )
+            buffer.addFrom( c, 0, m_convBuffer, c, 0, bufferSize );
+        else
+        {
+            auto out = buffer.getWritePointer( c );
+            auto convolved = m_convBuffer.getReadPointer( c );
+            for ( int i = 0; i < bufferSize; i++ )
+                out[ i ] += convolved[ i ];
+        }
     }
 }
 
+template < typename T >
+void Sjf_convoAudioProcessor::delayDrySignal( juce::AudioBuffer< T >& buffer )
+{
+    auto delay = m_dryDelay.getNumSamples();
+    if ( delay == 0 ){ return; }
+    auto bufferSize = buffer.getNumSamples();
+    for ( int c = 0; c < std::min( buffer.getNumChannels(), m_dryDelay.getNumChannels() ); c++ )
+    {
+        auto samples = buffer.getWritePointer( c );
+        auto delayLine = m_dryDelay.getWritePointer( c );
+        auto pos = m_dryDelayPosition;
+        for ( int i = 0; i < bufferSize; i++ )
+        {
+            auto delayed = delayLine[ pos ];
+            delayLine[ pos ] = samples[ i ];
+            samples[ i ] = (T)delayed;
+            if ( ++pos == delay ){ pos = 0; }
+        }
+    }
+    m_dryDelayPosition = ( m_dryDelayPosition + bufferSize ) % delay;
+}
+
 //==============================================================================
 bool Sjf_convoAudioProcessor::hasEditor() const
 {
@@ -235,7 +284,7 @@ void Sjf_convoAudioProcessor::setStateInformation (const void* data, int sizeInB
             filePathParameter.referTo( parameters.state.getPropertyAsValue("filepath", nullptr ) );
             if (filePathParameter != juce::Value{})
             {
-                m_convo.loadSample( filePathParameter );
+                changeImpulse( [ this ]{ m_convo.loadSample( filePathParameter ); } );
             }
             stretchParameter.referTo( parameters.state.getPropertyAsValue( "stretch", nullptr ) );
             setStretchFactor( stretchParameter.getValue() );
@@ -264,7 +313,7 @@ void Sjf_convoAudioProcessor::setStateInformation (const void* data, int sizeInB
                 indx1 %= 2;
                 eStr = eStr.substring( pos+1, eStr.length() );
             }
-            m_convo.setAmplitudeEnvelope( env );
+            setAmplitudeEnvelope( env );
         }
     }
     m_stateReloadedFlag = true;
@@ -318,6 +367,27 @@ void Sjf_convoAudioProcessor::setNonAutomatableParameterValues()
     envelopeParameterString.setValue( envString );
 }
 
+//==============================================================================
+void Sjf_convoAudioProcessor::impulseChanged()
+{
+    m_engineMeasurement.impulseChanged();
+    m_overviewBuilder.impulseChanged();
+}
+
+sjf_impulseSettings Sjf_convoAudioProcessor::getImpulseSettings()
+{
+    const juce::ScopedLock lock( m_impulseLock );
+    sjf_impulseSettings settings;
+    settings.filePath = m_convo.getFilePath();
+    settings.stretchFactor = m_convo.getStretchFactor();
+    settings.startAndEnd = m_convo.getImpulseStartAndEnd();
+    settings.reverse = m_convo.getReverseState();
+    settings.palindrome = m_convo.getPalindromeState();
+    settings.trimEnd = m_trimImpulseEnd;
+    settings.envelope = m_convo.getAmplitudeEnvelope();
+    return settings;
+}
+
 //==============================================================================
 // This creates new instances of the plugin..
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
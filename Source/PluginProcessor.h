@@ -12,6 +12,8 @@
 //#include "../../sjf_audio/JuceFIR.h"
 #include "../sjf_audio/sjf_convo.h"
 #include "../sjf_audio/sjf_audioUtilities.h"
+#include "sjf_waveformOverview.h"
+#include "sjf_convoMeasurement.h"
 //==============================================================================
 /**
 */
@@ -34,6 +36,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -58,21 +62,21 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
-    void loadImpulse(){ m_convo.loadImpulse(); }
+    void loadImpulse(){ changeImpulse( [ this ]{ m_convo.loadImpulse(); } ); }
     void PANIC(){ m_convo.PANIC(); }
-    void reverseImpulse( bool shouldReverseImpulse ){ m_convo.reverseImpulse( shouldReverseImpulse ); }
+    void reverseImpulse( bool shouldReverseImpulse ){ changeImpulse( [ this, shouldReverseImpulse ]{ m_convo.reverseImpulse( shouldReverseImpulse ); } ); }
     bool getReverseState() { return m_convo.getReverseState(); }
-    void palindromeImpulse( bool shouldMakePalindromeOfImpulse ){ m_convo.palindromeImpulse( shouldMakePalindromeOfImpulse ); }
+    void palindromeImpulse( bool shouldMakePalindromeOfImpulse ){ changeImpulse( [ this, shouldMakePalindromeOfImpulse ]{ m_convo.palindromeImpulse( shouldMakePalindromeOfImpulse ); } ); }
     bool getPalindromeState(){ return m_convo.getPalindromeState(); }
-    void trimImpulseEnd( bool shouldTrimImpulse ){ m_convo.trimImpulseEnd( shouldTrimImpulse ); }
+    void trimImpulseEnd( bool shouldTrimImpulse ){ changeImpulse( [ this, shouldTrimImpulse ]{ m_convo.trimImpulseEnd( shouldTrimImpulse ); m_trimImpulseEnd = shouldTrimImpulse; } ); }
     
-    void setImpulseStartAndEnd( float start0to1, float end0to1 ){ m_convo.setImpulseStartAndEnd( start0to1, end0to1 ); }
+    void setImpulseStartAndEnd( float start0to1, float end0to1 ){ changeImpulse( [ this, start0to1, end0to1 ]{ m_convo.setImpulseStartAndEnd( start0to1, end0to1 ); } ); }
     std::array< float, 2 > getStartAndEnd(){ return m_convo.getImpulseStartAndEnd(); }
     
-    void setAmplitudeEnvelope( std::vector< std::array< float, 2 > > env ) { m_convo.setAmplitudeEnvelope( env ); }
+    void setAmplitudeEnvelope( std::vector< std::array< float, 2 > > env ) { changeImpulse( [ this, &env ]{ m_convo.setAmplitudeEnvelope( env ); } ); }
     std::vector< std::array< float, 2 > > getAmplitudeEnvelope(){ return m_convo.getAmplitudeEnvelope(); }
     
-    void setStretchFactor( float stretchFactor ) { m_convo.setStretchFactor( std::pow( 2.0f, stretchFactor ) ); }
+    void setStretchFactor( float stretchFactor ) { changeImpulse( [ this, stretchFactor ]{ m_convo.setStretchFactor( std::pow( 2.0f, stretchFactor ) ); } ); }
     float getStretchFactor(){ return std::log2( m_convo.getStretchFactor() ); } 
     
     void setFilterPosition( int filterPosition ){ m_convo.setFilterPosition( filterPosition ); }
@@ -94,6 +98,8 @@ public:
     
     
     juce::AudioBuffer< float >& getIRBuffer(){ return m_convo.getIRBuffer(); }
+    // display summary of the current impulse, built in the background... may be null until the first one has been built
+    std::shared_ptr< const sjf_waveformOverview > getWaveformOverview() const { return m_overviewBuilder.getOverview(); }
     double getIRSampleRate() { return m_convo.getIRSampleRate(); }
     
     void setNonAutomatableParameterValues();
@@ -106,11 +112,34 @@ public:
     juce::String getFilePath(){ return m_convo.getFilePath(); }
     juce::String getFileName(){ return m_convo.getFileName(); }
 private:
+    template < typename T >
+    void processSamples( juce::AudioBuffer< T >& buffer );
+    template < typename T >
+    void delayDrySignal( juce::AudioBuffer< T >& buffer );
+    
+    // every call that changes the impulse the engine uses goes through here... the change is made under m_impulseLock so the overview builder always snapshots a complete impulse, and impulseChanged() then updates everything derived from it
+    template < typename F >
+    void changeImpulse( F&& change )
+    {
+        {
+            const juce::ScopedLock lock( m_impulseLock );
+            change();
+        }
+        impulseChanged();
+    }
+    void impulseChanged();
+    sjf_impulseSettings getImpulseSettings();
 
     juce::AudioProcessorValueTreeState parameters;
     
-    sjf_convo< 2, 2048 > m_convo; 
+    sjf_convo< 2, 2048 > m_convo;
+    juce::CriticalSection m_impulseLock;
+    // the engine has no getter for this
+    bool m_trimImpulseEnd = false;
     juce::AudioBuffer< float > m_convBuffer;
+    // delays the dry signal by the engine's latency, so it stays aligned with the wet signal once the host compensates
+    juce::AudioBuffer< double > m_dryDelay;
+    int m_dryDelayPosition = 0;
     float m_wet = 0, m_inputLevelDB = 0;
     
     
@@ -127,6 +156,14 @@ private:
     juce::Value envelopeParameterString;
     
     bool m_stateReloadedFlag = false;
+    
+    // declared last so their threads stop before anything they read is destroyed
+    sjf_convoMeasurement< sjf_convo< 2, 2048 >, 2 > m_engineMeasurement { [ this ]{ return getImpulseSettings(); } };
+    sjf_waveformOverviewBuilder m_overviewBuilder { [ this ]( juce::AudioBuffer< float >& snapshot )
+    {
+        const juce::ScopedLock lock( m_impulseLock );
+        snapshot.makeCopyOf( getIRBuffer(), true );
+    } };
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Sjf_convoAudioProcessor)
 };
@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+    sjf_convoMeasurement.h
+    Created: 19 Oct 2026
+    Author:  sjf
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+ Everything that decides the impulse a convolution engine uses, copied out so it can be applied to another instance of the engine
+*/
+struct sjf_impulseSettings
+{
+    juce::String filePath;
+    float stretchFactor = 1.0f;
+    std::array< float, 2 > startAndEnd { 0.0f, 1.0f };
+    bool reverse = false, palindrome = false, trimEnd = false;
+    std::vector< std::array< float, 2 > > envelope;
+};
+
+//==============================================================================
+/**
+ Measures a convolution engine's latency and the length of the impulse it has prepared, by running a unit impulse through a private instance of the engine
+ Latency is the delay before a single sample impulse response comes out... it is measured synchronously in prepare() because it depends on the sample rate and block size
+ Impulse length is the last output sample above SILENCE_THRESHOLD_DB (relative to the peak) with the current impulse and all its settings loaded... it is measured on its own thread whenever impulseChanged() is called, so trimming, reversing, palindrome, stretching and the envelope are all counted exactly as the engine applies them
+*/
+template < typename CONVO, int NCHANNELS >
+class sjf_convoMeasurement : private juce::Thread
+{
+public:
+    static constexpr float SILENCE_THRESHOLD_DB = -100.0f;
+
+    sjf_convoMeasurement( std::function< sjf_impulseSettings() > getSettings )
+    : juce::Thread( "sjf_convoMeasurement" ), m_getSettings( std::move( getSettings ) )
+    {
+        startThread();
+    }
+
+    ~sjf_convoMeasurement() override { stopThread( 4000 ); }
+
+    // call from prepareToPlay... returns the engine's latency in samples and remeasures the impulse length for the new sample rate and block size
+    int prepare( double sampleRate, int samplesPerBlock )
+    {
+        m_latencySamples = measureLatency( sampleRate, samplesPerBlock );
+        m_sampleRate = sampleRate;
+        m_blockSize = samplesPerBlock;
+        impulseChanged();
+        return m_latencySamples;
+    }
+
+    // call after the impulse has changed... cheap, the measurement happens in the background
+    void impulseChanged()
+    {
+        m_measurePending = true;
+        notify();
+    }
+
+    int getLatencySamples() const { return m_latencySamples; }
+
+    // length of the impulse the engine has prepared, without latency or pre-delay... 0 until the first measurement has finished
+    double getImpulseLengthSeconds() const { return m_impulseLengthSeconds; }
+
+private:
+    void run() override
+    {
+        while ( ! threadShouldExit() )
+        {
+            // several changes in quick succession only need one measurement
+            if ( ! m_measurePending.exchange( false ) )
+            {
+                wait( -1 );
+                continue;
+            }
+            auto sampleRate = m_sampleRate.load();
+            auto blockSize = m_blockSize.load();
+            if ( sampleRate <= 0 || blockSize <= 0 ){ continue; }
+            auto settings = m_getSettings();
+            auto nSamples = maximumImpulseLength( settings, sampleRate );
+            if ( nSamples <= 0 )
+            {
+                m_impulseLengthSeconds = 0.0;
+                continue;
+            }
+            auto latency = m_latencySamples.load();
+            auto output = runUnitImpulse( settings, sampleRate, blockSize, latency + nSamples, [ this ]{ return threadShouldExit() || m_measurePending.load(); } );
+            // empty if a newer change arrived part way through, which will be measured next time round
+            if ( output.empty() ){ continue; }
+            auto peak = *std::max_element( output.begin(), output.end() );
+            if ( peak <= 0.0f )
+            {
+                m_impulseLengthSeconds = 0.0;
+                continue;
+            }
+            auto threshold = peak * juce::Decibels::decibelsToGain( SILENCE_THRESHOLD_DB );
+            auto last = (int)output.size() - 1;
+            while ( output[ last ] < threshold )
+                last--;
+            m_impulseLengthSeconds = std::max( last + 1 - latency, 0 ) / sampleRate;
+        }
+    }
+
+    static int measureLatency( double sampleRate, int samplesPerBlock )
+    {
+        juce::TemporaryFile unitImpulseFile( ".wav" );
+        if ( ! writeUnitImpulse( unitImpulseFile.getFile(), sampleRate ) )
+        {
+            jassertfalse;
+            return 0;
+        }
+        sjf_impulseSettings settings;
+        settings.filePath = unitImpulseFile.getFile().getFullPathName();
+        auto output = runUnitImpulse( settings, sampleRate, samplesPerBlock, LATENCY_SEARCH_LENGTH + samplesPerBlock, []{ return false; } );
+        auto peak = *std::max_element( output.begin(), output.end() );
+        if ( peak <= 0.0f )
+        {
+            // nothing came out, so the engine failed to load the unit impulse
+            jassertfalse;
+            return 0;
+        }
+        auto onset = std::find_if( output.begin(), output.end(), [ peak ]( float x ){ return x >= 0.5f * peak; } );
+        return (int)std::distance( output.begin(), onset );
+    }
+
+    static bool writeUnitImpulse( const juce::File& file, double sampleRate )
+    {
+        juce::AudioBuffer< float > impulse( 1, UNIT_IMPULSE_FILE_LENGTH );
+        impulse.clear();
+        impulse.setSample( 0, 0, 1.0f );
+        auto stream = std::make_unique< juce::FileOutputStream >( file );
+        if ( stream->failedToOpen() ){ return false; }
+        juce::WavAudioFormat wav;
+        std::unique_ptr< juce::AudioFormatWriter > writer( wav.createWriterFor( stream.get(), sampleRate, 1, 24, {}, 0 ) );
+        if ( writer == nullptr ){ return false; }
+        // the writer owns the stream now
+        stream.release();
+        return writer->writeFromAudioSampleBuffer( impulse, 0, impulse.getNumSamples() );
+    }
+
+    // upper bound on the prepared impulse length at sampleRate: the file length, doubled for a palindrome and stretched, with headroom in case the engine's stretch isn't exactly proportional
+    static int maximumImpulseLength( const sjf_impulseSettings& settings, double sampleRate )
+    {
+        if ( ! juce::File::isAbsolutePath( settings.filePath ) ){ return 0; }
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        std::unique_ptr< juce::AudioFormatReader > reader( formatManager.createReaderFor( juce::File( settings.filePath ) ) );
+        if ( reader == nullptr || reader->sampleRate <= 0 ){ return 0; }
+        auto length = reader->lengthInSamples * ( sampleRate / reader->sampleRate ) * ( settings.palindrome ? 2.0 : 1.0 ) * settings.stretchFactor;
+        return (int)std::min( std::ceil( length * 1.25 ) + LATENCY_SEARCH_LENGTH, (double)std::numeric_limits< int >::max() / 2 );
+    }
+
+    // loads settings into a private engine, feeds it a unit impulse and returns the largest absolute output of any channel for each of nSamples samples... empty if shouldStop() returned true along the way
+    static std::vector< float > runUnitImpulse( const sjf_impulseSettings& settings, double sampleRate, int blockSize, int nSamples, const std::function< bool() >& shouldStop )
+    {
+        auto engine = std::make_unique< CONVO >();
+        engine->prepare( sampleRate, blockSize );
+        engine->trimImpulseEnd( settings.trimEnd );
+        juce::Value filePath( settings.filePath );
+        engine->loadSample( filePath );
+        engine->setStretchFactor( settings.stretchFactor );
+        engine->setImpulseStartAndEnd( settings.startAndEnd[ 0 ], settings.startAndEnd[ 1 ] );
+        engine->reverseImpulse( settings.reverse );
+        engine->palindromeImpulse( settings.palindrome );
+        if ( ! settings.envelope.empty() ){ engine->setAmplitudeEnvelope( settings.envelope ); }
+        // filters off, no pre-delay
+        engine->setFilterPosition( 1 );
+        engine->setPreDelay( 0.0f );
+
+        std::vector< float > output( nSamples, 0.0f );
+        juce::AudioBuffer< float > block( NCHANNELS, blockSize );
+        for ( int pos = 0; pos < nSamples; pos += blockSize )
+        {
+            if ( shouldStop() ){ return {}; }
+            auto n = std::min( blockSize, nSamples - pos );
+            block.setSize( NCHANNELS, n, false, false, true );
+            block.clear();
+            if ( pos == 0 )
+                for ( int c = 0; c < NCHANNELS; c++ )
+                    block.setSample( c, 0, 1.0f );
+            engine->process( block );
+            for ( int c = 0; c < NCHANNELS; c++ )
+            {
+                auto samples = block.getReadPointer( c );
+                for ( int i = 0; i < n; i++ )
+                    output[ pos + i ] = std::max( output[ pos + i ], std::abs( samples[ i ] ) );
+            }
+        }
+        return output;
+    }
+
+    // how far to look for the unit impulse when measuring latency, on top of one block... several times the largest partition the engine uses
+    static constexpr int LATENCY_SEARCH_LENGTH = 1 << 15;
+    static constexpr int UNIT_IMPULSE_FILE_LENGTH = 64;
+
+    std::function< sjf_impulseSettings() > m_getSettings;
+    std::atomic< double > m_sampleRate { 0.0 }, m_impulseLengthSeconds { 0.0 };
+    std::atomic< int > m_blockSize { 0 }, m_latencySamples { 0 };
+    std::atomic< bool > m_measurePending { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (sjf_convoMeasurement)
+};
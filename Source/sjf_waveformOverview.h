@@ -0,0 +1,287 @@
+/*
+  ==============================================================================
+
+    sjf_waveformOverview.h
+    Created: 19 Oct 2026
+    Author:  sjf
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+ Read only min/max/rms pyramid of an impulse response for display
+ Level 0 summarises BASE_BIN_SIZE samples per bin and each level above halves the number of bins, so drawing any range at any zoom only reads a couple of bins per pixel
+ Built by sjf_waveformOverviewBuilder and then shared read only with the editor, so the GUI never touches the impulse the audio thread is using
+*/
+class sjf_waveformOverview
+{
+public:
+    static constexpr int BASE_BIN_SIZE = 16;
+
+    sjf_waveformOverview( const juce::AudioBuffer< float >& impulse )
+    : m_nSamples( impulse.getNumSamples() )
+    {
+        m_channels.resize( impulse.getNumChannels() );
+        for ( int c = 0; c < impulse.getNumChannels(); c++ )
+            buildChannel( impulse.getReadPointer( c ), m_channels[ c ] );
+    }
+
+    int getNumChannels() const { return (int)m_channels.size(); }
+    int getNumSamples() const { return m_nSamples; }
+    int getNumLevels() const { return m_channels.empty() ? 0 : (int)m_channels[ 0 ].size(); }
+
+    //==============================================================================
+    // fills minima and maxima with one value per pixel for each channel, covering samples startSample to endSample (the whole impulse by default)
+    void renderMinMax( int nPixels, juce::AudioBuffer< float >& minima, juce::AudioBuffer< float >& maxima, int startSample = 0, int endSample = -1 ) const
+    {
+        for ( auto dest : { &minima, &maxima } )
+        {
+            dest->setSize( std::max( getNumChannels(), 1 ), std::max( nPixels, 0 ), false, false, true );
+            dest->clear();
+        }
+        endSample = endSample < 0 ? m_nSamples : std::min( endSample, m_nSamples );
+        if ( nPixels <= 0 || endSample <= startSample || getNumLevels() == 0 ){ return; }
+
+        auto samplesPerPixel = (double)( endSample - startSample ) / nPixels;
+        auto level = chooseLevel( samplesPerPixel );
+        for ( int c = 0; c < getNumChannels(); c++ )
+        {
+            auto& l = m_channels[ c ][ level ];
+            auto outMin = minima.getWritePointer( c );
+            auto outMax = maxima.getWritePointer( c );
+            for ( int p = 0; p < nPixels; p++ )
+            {
+                auto range = binRange( l, startSample + p * samplesPerPixel, startSample + ( p + 1 ) * samplesPerPixel );
+                auto mx = l.max[ range.getStart() ], mn = l.min[ range.getStart() ];
+                for ( int b = range.getStart() + 1; b < range.getEnd(); b++ )
+                {
+                    mx = std::max( mx, l.max[ b ] );
+                    mn = std::min( mn, l.min[ b ] );
+                }
+                outMin[ p ] = mn;
+                outMax[ p ] = mx;
+            }
+        }
+    }
+
+    // rms of each pixel, covering samples startSample to endSample (the whole impulse by default)
+    void renderRMS( int nPixels, juce::AudioBuffer< float >& dest, int startSample = 0, int endSample = -1 ) const
+    {
+        dest.setSize( std::max( getNumChannels(), 1 ), std::max( nPixels, 0 ), false, false, true );
+        dest.clear();
+        endSample = endSample < 0 ? m_nSamples : std::min( endSample, m_nSamples );
+        if ( nPixels <= 0 || endSample <= startSample || getNumLevels() == 0 ){ return; }
+
+        auto samplesPerPixel = (double)( endSample - startSample ) / nPixels;
+        auto level = chooseLevel( samplesPerPixel );
+        for ( int c = 0; c < getNumChannels(); c++ )
+        {
+            auto& l = m_channels[ c ][ level ];
+            auto out = dest.getWritePointer( c );
+            for ( int p = 0; p < nPixels; p++ )
+            {
+                auto range = binRange( l, startSample + p * samplesPerPixel, startSample + ( p + 1 ) * samplesPerPixel );
+                auto sumSquares = 0.0f;
+                for ( int b = range.getStart(); b < range.getEnd(); b++ )
+                    sumSquares += l.rms[ b ] * l.rms[ b ];
+                out[ p ] = std::sqrt( sumSquares / range.getLength() );
+            }
+        }
+    }
+
+private:
+    struct level
+    {
+        int binSize = BASE_BIN_SIZE;
+        std::vector< float > min, max, rms;
+    };
+
+    void buildChannel( const float* samples, std::vector< level >& levels )
+    {
+        level base;
+        auto nBins = std::max( ( m_nSamples + BASE_BIN_SIZE - 1 ) / BASE_BIN_SIZE, 1 );
+        base.min.resize( nBins, 0.0f ); base.max.resize( nBins, 0.0f ); base.rms.resize( nBins, 0.0f );
+        for ( int b = 0; b < nBins && m_nSamples > 0; b++ )
+        {
+            auto start = b * BASE_BIN_SIZE;
+            auto n = std::min( BASE_BIN_SIZE, m_nSamples - start );
+            auto range = juce::FloatVectorOperations::findMinAndMax( samples + start, n );
+            base.min[ b ] = range.getStart();
+            base.max[ b ] = range.getEnd();
+            auto sumSquares = 0.0f;
+            for ( int i = start; i < start + n; i++ )
+                sumSquares += samples[ i ] * samples[ i ];
+            base.rms[ b ] = std::sqrt( sumSquares / n );
+        }
+        levels.push_back( std::move( base ) );
+
+        while ( levels.back().min.size() > 1 )
+        {
+            auto& below = levels.back();
+            level next;
+            next.binSize = below.binSize * 2;
+            auto n = ( below.min.size() + 1 ) / 2;
+            next.min.resize( n ); next.max.resize( n ); next.rms.resize( n );
+            for ( size_t b = 0; b < n; b++ )
+            {
+                auto i = b * 2, j = std::min( i + 1, below.min.size() - 1 );
+                next.min[ b ] = std::min( below.min[ i ], below.min[ j ] );
+                next.max[ b ] = std::max( below.max[ i ], below.max[ j ] );
+                next.rms[ b ] = std::sqrt( 0.5f * ( below.rms[ i ] * below.rms[ i ] + below.rms[ j ] * below.rms[ j ] ) );
+            }
+            levels.push_back( std::move( next ) );
+        }
+    }
+
+    // coarsest level that still has at least one bin per pixel
+    int chooseLevel( double samplesPerPixel ) const
+    {
+        auto& levels = m_channels[ 0 ];
+        int l = 0;
+        while ( l + 1 < (int)levels.size() && levels[ l + 1 ].binSize <= samplesPerPixel )
+            l++;
+        return l;
+    }
+
+    static juce::Range< int > binRange( const level& l, double startSample, double endSample )
+    {
+        auto nBins = (int)l.min.size();
+        auto first = juce::jlimit( 0, nBins - 1, (int)( startSample / l.binSize ) );
+        auto last = juce::jlimit( first + 1, nBins, (int)std::ceil( endSample / l.binSize ) );
+        return { first, last };
+    }
+
+    int m_nSamples;
+    std::vector< std::vector< level > > m_channels;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (sjf_waveformOverview)
+};
+
+//==============================================================================
+/**
+ Rebuilds the waveform overview on its own thread whenever the impulse changes
+ The snapshot of the impulse is taken on this thread by copyImpulse (which should hold whatever lock guards the impulse while the engine prepares it), so the message thread never copies or walks the impulse
+*/
+class sjf_waveformOverviewBuilder : private juce::Thread
+{
+public:
+    sjf_waveformOverviewBuilder( std::function< void( juce::AudioBuffer< float >& ) > copyImpulse )
+    : juce::Thread( "sjf_waveformOverviewBuilder" ), m_copyImpulse( std::move( copyImpulse ) )
+    {
+        startThread();
+    }
+
+    ~sjf_waveformOverviewBuilder() override { stopThread( 2000 ); }
+
+    // call after the impulse has changed... cheap, the rebuild happens in the background
+    void impulseChanged()
+    {
+        m_rebuildPending = true;
+        notify();
+    }
+
+    // may be null until the first overview has been built
+    std::shared_ptr< const sjf_waveformOverview > getOverview() const { return std::atomic_load( &m_overview ); }
+
+private:
+    void run() override
+    {
+        while ( ! threadShouldExit() )
+        {
+            // several changes in quick succession only need one rebuild
+            if ( ! m_rebuildPending.exchange( false ) )
+            {
+                wait( -1 );
+                continue;
+            }
+            m_copyImpulse( m_snapshot );
+            std::shared_ptr< const sjf_waveformOverview > overview = std::make_shared< sjf_waveformOverview >( m_snapshot );
+            std::atomic_store( &m_overview, overview );
+        }
+    }
+
+    std::function< void( juce::AudioBuffer< float >& ) > m_copyImpulse;
+    juce::AudioBuffer< float > m_snapshot;
+    std::shared_ptr< const sjf_waveformOverview > m_overview;
+    std::atomic< bool > m_rebuildPending { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (sjf_waveformOverviewBuilder)
+};
+
+//==============================================================================
+/**
+ Transparent overlay that draws a waveform overview as min/max and rms lines, one lane per channel
+ Sits on top of the waveform display with the same bounds and ignores the mouse, so the display underneath still handles envelope editing
+*/
+class sjf_waveformOverviewDisplay : public juce::Component
+{
+public:
+    sjf_waveformOverviewDisplay()
+    {
+        setInterceptsMouseClicks( false, false );
+        setOpaque( false );
+    }
+
+    void setOverview( std::shared_ptr< const sjf_waveformOverview > overview )
+    {
+        m_overview = std::move( overview );
+        render();
+    }
+
+    const std::shared_ptr< const sjf_waveformOverview >& getOverview() const { return m_overview; }
+
+    void paint( juce::Graphics& g ) override
+    {
+        auto nPixels = m_max.getNumSamples();
+        auto nChannels = m_max.getNumChannels();
+        if ( nPixels == 0 || nChannels == 0 ){ return; }
+        auto halfHeight = getHeight() * 0.5f / nChannels;
+        for ( int c = 0; c < nChannels; c++ )
+        {
+            auto centre = halfHeight * ( 2 * c + 1 );
+            auto minima = m_min.getReadPointer( c );
+            auto maxima = m_max.getReadPointer( c );
+            auto rms = m_rms.getReadPointer( c );
+            g.setColour( juce::Colours::white.withAlpha( 0.3f ) );
+            for ( int x = 0; x < nPixels; x++ )
+                g.drawVerticalLine( x, centre - juce::jlimit( -1.0f, 1.0f, maxima[ x ] ) * halfHeight, centre - juce::jlimit( -1.0f, 1.0f, minima[ x ] ) * halfHeight );
+            g.setColour( juce::Colours::white.withAlpha( 0.6f ) );
+            for ( int x = 0; x < nPixels; x++ )
+            {
+                auto r = std::min( rms[ x ], 1.0f ) * halfHeight;
+                g.drawVerticalLine( x, centre - r, centre + r );
+            }
+        }
+    }
+
+    void resized() override { render(); }
+
+private:
+    // min, max and rms are rendered once per overview or size change, so painting only draws lines
+    void render()
+    {
+        auto nPixels = m_overview == nullptr ? 0 : getWidth();
+        if ( nPixels > 0 )
+        {
+            m_overview->renderMinMax( nPixels, m_min, m_max );
+            m_overview->renderRMS( nPixels, m_rms );
+        }
+        else
+        {
+            m_min.setSize( 0, 0 );
+            m_max.setSize( 0, 0 );
+            m_rms.setSize( 0, 0 );
+        }
+        repaint();
+    }
+
+    std::shared_ptr< const sjf_waveformOverview > m_overview;
+    juce::AudioBuffer< float > m_min, m_max, m_rms;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (sjf_waveformOverviewDisplay)
+};